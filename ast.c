@@ -1,6 +1,7 @@
 #include "ast.h"
 #include "lex.yy.h"
 #include "parser.tab.h"
+#include <limits.h>
 
 #define AST_CAST_SELF(type)                                                    \
   struct ast_##type *self = AST_CAST(node, struct ast_##type);
@@ -57,6 +58,13 @@ static void ast_traverse_print_var_list(struct ast *node, int indent) {
 static void ast_traverse_print_decl_var(struct ast *node, int indent) {
   TRAVERSE_PRINT_HEADER(decl_var)
   printf(" %s [ %d ]\n", self->name, self->size);
+  ast_traverse_print(self->init, indent + 1);
+}
+
+static void ast_traverse_print_init_list(struct ast *node, int indent) {
+  TRAVERSE_PRINT_HEADER(init_list)
+  printf(" %d\n", self->value);
+  ast_traverse_print(self->next, indent);
 }
 
 static void ast_traverse_print_op_list(struct ast *node, int indent) {
@@ -171,13 +179,597 @@ static void ast_traverse_print_refname(struct ast *node, int indent) {
   printf(" %s\n", self->name);
 }
 
+static struct ast_metatable ast_metatable_global;
+static struct ast_metatable ast_metatable_procedure;
+static struct ast_metatable ast_metatable_var_list;
+static struct ast_metatable ast_metatable_op_list;
+static struct ast_metatable ast_metatable_proc_call;
+static struct ast_metatable ast_metatable_push_list;
+static struct ast_metatable ast_metatable_assign;
+static struct ast_metatable ast_metatable_if;
+static struct ast_metatable ast_metatable_while;
+static struct ast_metatable ast_metatable_binop;
+static struct ast_metatable ast_metatable_unop;
+static struct ast_metatable ast_metatable_constant;
+static struct ast_metatable ast_metatable_refname;
+
+// Number of profile counters allocated while translating the subtree, must
+// stay in sync with the allocation order of the translate functions.
+static int profile_counters(struct ast *node) {
+  if (!node)
+    return 0;
+  if (node->metatable == &ast_metatable_global) {
+    struct ast_global *global = AST_CAST(node, struct ast_global);
+    return profile_counters(global->item) + profile_counters(global->next);
+  }
+  if (node->metatable == &ast_metatable_procedure) {
+    struct ast_procedure *proc = AST_CAST(node, struct ast_procedure);
+    return 1 + profile_counters(proc->code);
+  }
+  if (node->metatable == &ast_metatable_op_list) {
+    struct ast_op_list *list = AST_CAST(node, struct ast_op_list);
+    return profile_counters(list->op) + profile_counters(list->next);
+  }
+  if (node->metatable == &ast_metatable_if) {
+    struct ast_if *if_ = AST_CAST(node, struct ast_if);
+    return 2 + profile_counters(if_->if_true) +
+           profile_counters(if_->if_false);
+  }
+  if (node->metatable == &ast_metatable_while) {
+    struct ast_while *while_ = AST_CAST(node, struct ast_while);
+    return 1 + profile_counters(while_->body);
+  }
+  return 0;
+}
+
+static int profile_count(struct translate_context *context, int counter) {
+  if (!context->profile || counter >= context->profile_size)
+    return 0;
+  return context->profile[counter];
+}
+
+// Translates a basic block whose entry is counted by `counter`, nested
+// counters are allocated starting from `first`.
+static void translate_profile_block(struct ast *code, int counter, int first,
+                                    struct translate_context *context) {
+  int block = context->profile_block;
+  context->profile_block = counter;
+  if (context->instrument) {
+    printf("\tli x3, l_prof_counters\n");
+    printf("\taddi x3, x3, %d\n", counter);
+    printf("\tlw x4, x3, 0\n");
+    printf("\taddi x4, x4, 1\n");
+    printf("\tsw x3, 0, x4\n");
+  }
+  context->profile_counter = first;
+  context->tail_jumped = 0;
+  ast_traverse_translate(code, context);
+  context->profile_block = block;
+}
+
+#define SPECIALIZE_BUDGET 256
+
+static int ast_children(struct ast *node, struct ast **children) {
+  if (node->metatable == &ast_metatable_op_list) {
+    struct ast_op_list *list = AST_CAST(node, struct ast_op_list);
+    children[0] = list->op;
+    children[1] = list->next;
+    return 2;
+  }
+  if (node->metatable == &ast_metatable_proc_call) {
+    children[0] = AST_CAST(node, struct ast_proc_call)->push_list;
+    return 1;
+  }
+  if (node->metatable == &ast_metatable_push_list) {
+    struct ast_push_list *list = AST_CAST(node, struct ast_push_list);
+    children[0] = list->expr;
+    children[1] = list->next;
+    return 2;
+  }
+  if (node->metatable == &ast_metatable_assign) {
+    struct ast_assign *assign = AST_CAST(node, struct ast_assign);
+    children[0] = assign->left;
+    children[1] = assign->right;
+    return 2;
+  }
+  if (node->metatable == &ast_metatable_if) {
+    struct ast_if *if_ = AST_CAST(node, struct ast_if);
+    children[0] = if_->cond;
+    children[1] = if_->if_true;
+    children[2] = if_->if_false;
+    return 3;
+  }
+  if (node->metatable == &ast_metatable_while) {
+    struct ast_while *while_ = AST_CAST(node, struct ast_while);
+    children[0] = while_->cond;
+    children[1] = while_->body;
+    return 2;
+  }
+  if (node->metatable == &ast_metatable_binop) {
+    struct ast_binop *binop = AST_CAST(node, struct ast_binop);
+    children[0] = binop->left;
+    children[1] = binop->right;
+    return 2;
+  }
+  if (node->metatable == &ast_metatable_unop) {
+    children[0] = AST_CAST(node, struct ast_unop)->arg;
+    return 1;
+  }
+  return 0;
+}
+
+static int ast_size(struct ast *node) {
+  if (!node)
+    return 0;
+  struct ast *children[3];
+  int count = ast_children(node, children);
+  int size = 1;
+  for (int i = 0; i < count; ++i)
+    size += ast_size(children[i]);
+  return size;
+}
+
+static int ast_is_refname(struct ast *node, char const *name) {
+  return node && node->metatable == &ast_metatable_refname &&
+         strcmp(AST_CAST(node, struct ast_refname)->name, name) == 0;
+}
+
+// Counts the uses of `name`, how many of them are plain loads `*name` and
+// how many are plain stores `name := ...`.
+static void ast_count_uses(struct ast *node, char const *name, int *uses,
+                           int *loads, int *stores) {
+  if (!node)
+    return;
+  if (ast_is_refname(node, name))
+    (*uses)++;
+  if (node->metatable == &ast_metatable_unop &&
+      AST_CAST(node, struct ast_unop)->code == '*' &&
+      ast_is_refname(AST_CAST(node, struct ast_unop)->arg, name))
+    (*loads)++;
+  if (node->metatable == &ast_metatable_assign &&
+      ast_is_refname(AST_CAST(node, struct ast_assign)->left, name))
+    (*stores)++;
+  struct ast *children[3];
+  int count = ast_children(node, children);
+  for (int i = 0; i < count; ++i)
+    ast_count_uses(children[i], name, uses, loads, stores);
+}
+
+// A variable whose address never escapes and is never stored to keeps the
+// value it had on entry to the procedure.
+static int proc_reads_only(struct ast_procedure *proc, char const *name) {
+  int uses = 0;
+  int loads = 0;
+  int stores = 0;
+  ast_count_uses(proc->code, name, &uses, &loads, &stores);
+  return uses == loads;
+}
+
+static int proc_escapes(struct ast_procedure *proc, char const *name) {
+  int uses = 0;
+  int loads = 0;
+  int stores = 0;
+  ast_count_uses(proc->code, name, &uses, &loads, &stores);
+  return uses > loads + stores;
+}
+
+// Whether the address of a local or an argument may be kept somewhere, in
+// which case the frame must outlive any call made by the procedure.
+static int proc_frame_escapes(struct ast_procedure *proc) {
+  for (struct ast *var_ = proc->vars; var_;) {
+    struct ast_var_list *var = AST_CAST(var_, struct ast_var_list);
+    if (proc_escapes(proc, AST_CAST(var->decl, struct ast_decl_var)->name))
+      return 1;
+    var_ = var->next;
+  }
+  struct ast_proc_header *header =
+      AST_CAST(proc->header, struct ast_proc_header);
+  for (struct ast *arg_ = header->args; arg_;) {
+    struct ast_arg_list *arg = AST_CAST(arg_, struct ast_arg_list);
+    if (proc_escapes(proc, arg->name))
+      return 1;
+    arg_ = arg->next;
+  }
+  return 0;
+}
+
+static int translate_push_count(struct ast *push_) {
+  int count = 0;
+  for (; push_; count++)
+    push_ = AST_CAST(push_, struct ast_push_list)->next;
+  return count;
+}
+
+static int translate_arg_count(struct ast *arg_) {
+  int count = 0;
+  for (; arg_; count++)
+    arg_ = AST_CAST(arg_, struct ast_arg_list)->next;
+  return count;
+}
+
+static int proc_has_var(struct ast_procedure *proc, char const *name) {
+  for (struct ast *var_ = proc->vars; var_;) {
+    struct ast_var_list *var = AST_CAST(var_, struct ast_var_list);
+    if (strcmp(AST_CAST(var->decl, struct ast_decl_var)->name, name) == 0)
+      return 1;
+    var_ = var->next;
+  }
+  return 0;
+}
+
+static int proc_has_arg(struct ast_procedure *proc, char const *name) {
+  struct ast_proc_header *header =
+      AST_CAST(proc->header, struct ast_proc_header);
+  for (struct ast *arg_ = header->args; arg_;) {
+    struct ast_arg_list *arg = AST_CAST(arg_, struct ast_arg_list);
+    if (strcmp(arg->name, name) == 0)
+      return 1;
+    arg_ = arg->next;
+  }
+  return 0;
+}
+
+// Builds the table of global variables and marks the scalars that no
+// procedure ever writes or takes the address of as constants.
+static void translate_collect_globals(struct translate_context *context) {
+  int count = 0;
+  for (struct ast *global_ = context->program; global_;) {
+    struct ast_global *global = AST_CAST(global_, struct ast_global);
+    for (struct ast *var_ = global->item;
+         var_ && var_->metatable == &ast_metatable_var_list;) {
+      count++;
+      var_ = AST_CAST(var_, struct ast_var_list)->next;
+    }
+    global_ = global->next;
+  }
+  context->globals = malloc(sizeof(struct translate_global) * (count + 1));
+  context->global_count = 0;
+  for (struct ast *global_ = context->program; global_;) {
+    struct ast_global *global = AST_CAST(global_, struct ast_global);
+    for (struct ast *var_ = global->item;
+         var_ && var_->metatable == &ast_metatable_var_list;) {
+      struct ast_var_list *var = AST_CAST(var_, struct ast_var_list);
+      struct translate_global *entry =
+          &context->globals[context->global_count++];
+      entry->decl = AST_CAST(var->decl, struct ast_decl_var);
+      entry->constant = entry->decl->size == 1;
+      entry->heat = 0;
+      var_ = var->next;
+    }
+    global_ = global->next;
+  }
+  for (struct ast *global_ = context->program; global_;) {
+    struct ast_global *global = AST_CAST(global_, struct ast_global);
+    if (global->item->metatable == &ast_metatable_procedure) {
+      struct ast_procedure *proc = AST_CAST(global->item, struct ast_procedure);
+      for (int i = 0; i < context->global_count; ++i) {
+        char const *name = context->globals[i].decl->name;
+        if (context->globals[i].constant && !proc_has_var(proc, name) &&
+            !proc_has_arg(proc, name) && !proc_reads_only(proc, name))
+          context->globals[i].constant = 0;
+      }
+    }
+    global_ = global->next;
+  }
+}
+
+static struct ast_procedure *
+translate_find_proc(struct translate_context *context, char const *name,
+                    int *counter) {
+  *counter = 0;
+  for (struct ast *global_ = context->program; global_;) {
+    struct ast_global *global = AST_CAST(global_, struct ast_global);
+    if (global->item->metatable == &ast_metatable_procedure) {
+      struct ast_procedure *proc = AST_CAST(global->item, struct ast_procedure);
+      if (strcmp(AST_CAST(proc->header, struct ast_proc_header)->name, name) ==
+          0)
+        return proc;
+      *counter += profile_counters(global->item);
+    }
+    global_ = global->next;
+  }
+  return NULL;
+}
+
+// Marks the generic procedure as called, returns 0 when there is none.
+static int translate_need_proc(struct translate_context *context,
+                               char const *name) {
+  for (int i = 0; i < context->proc_count; ++i) {
+    struct ast_proc_header *header =
+        AST_CAST(context->procs[i].proc->header, struct ast_proc_header);
+    if (strcmp(header->name, name) == 0) {
+      context->procs[i].needed = 1;
+      return 1;
+    }
+  }
+  return 0;
+}
+
+// Resolves `*name` the same way as the refname translation does and tells
+// whether the loaded value is known at compile time.
+static int translate_const_load(struct ast *node,
+                                struct translate_context *context,
+                                int *value) {
+  if (!node || node->metatable != &ast_metatable_refname)
+    return 0;
+  char const *name = AST_CAST(node, struct ast_refname)->name;
+  for (struct ast *var_ = context->proc_vars; var_;) {
+    struct ast_var_list *var = AST_CAST(var_, struct ast_var_list);
+    if (strcmp(AST_CAST(var->decl, struct ast_decl_var)->name, name) == 0)
+      return 0;
+    var_ = var->next;
+  }
+  int index = 0;
+  for (struct ast *arg_ = context->proc_args; arg_; ++index) {
+    struct ast_arg_list *arg = AST_CAST(arg_, struct ast_arg_list);
+    if (strcmp(arg->name, name) == 0) {
+      if (!context->proc_consts || !context->proc_consts[index].known)
+        return 0;
+      *value = context->proc_consts[index].value;
+      return 1;
+    }
+    arg_ = arg->next;
+  }
+  for (int i = 0; i < context->global_count; ++i) {
+    if (strcmp(context->globals[i].decl->name, name) == 0) {
+      struct ast *init = context->globals[i].decl->init;
+      if (!context->globals[i].constant)
+        return 0;
+      *value = init ? AST_CAST(init, struct ast_init_list)->value : 0;
+      return 1;
+    }
+  }
+  return 0;
+}
+
+static int translate_const_value(struct ast *node,
+                                 struct translate_context *context,
+                                 int *value) {
+  if (!node)
+    return 0;
+  if (node->metatable == &ast_metatable_constant) {
+    *value = AST_CAST(node, struct ast_constant)->value;
+    return 1;
+  }
+  if (node->metatable == &ast_metatable_unop) {
+    struct ast_unop *unop = AST_CAST(node, struct ast_unop);
+    if (unop->code == '*')
+      return translate_const_load(unop->arg, context, value);
+    if (!translate_const_value(unop->arg, context, value))
+      return 0;
+    switch (unop->code) {
+    case '-':
+      *value = (int)(0u - (unsigned)*value);
+      return 1;
+    case '+':
+      return 1;
+    case T_NOT:
+      *value = ~*value;
+      return 1;
+    }
+    return 0;
+  }
+  if (node->metatable == &ast_metatable_binop) {
+    struct ast_binop *binop = AST_CAST(node, struct ast_binop);
+    int left;
+    int right;
+    if (!translate_const_value(binop->left, context, &left) ||
+        !translate_const_value(binop->right, context, &right))
+      return 0;
+    switch (binop->code) {
+    // Wrap around like the target's add, sub and mul do
+    case '+':
+      *value = (int)((unsigned)left + (unsigned)right);
+      return 1;
+    case '-':
+      *value = (int)((unsigned)left - (unsigned)right);
+      return 1;
+    case '*':
+      *value = (int)((unsigned)left * (unsigned)right);
+      return 1;
+    case '/':
+    case '%':
+      if (right == 0 || (left == INT_MIN && right == -1))
+        return 0;
+      *value = binop->code == '/' ? left / right : left % right;
+      return 1;
+    case T_EQ:
+      *value = left == right;
+      return 1;
+    case T_NEQ:
+      *value = left != right;
+      return 1;
+    case '>':
+      *value = left > right;
+      return 1;
+    case '<':
+      *value = left < right;
+      return 1;
+    case T_AND:
+      *value = left & right;
+      return 1;
+    case T_OR:
+      *value = left | right;
+      return 1;
+    case T_XOR:
+      *value = left ^ right;
+      return 1;
+    }
+  }
+  return 0;
+}
+
+// Fills `args` with the arguments of the call that are known at compile time
+// and returns how many of them there are.
+static int translate_const_args(struct ast_proc_call *call,
+                                struct ast_procedure *proc,
+                                struct translate_context *context,
+                                struct translate_const *args) {
+  struct ast_proc_header *header =
+      AST_CAST(proc->header, struct ast_proc_header);
+  int known = 0;
+  struct ast *push_ = call->push_list;
+  struct ast *arg_ = header->args;
+  for (int i = 0; arg_ && push_; ++i) {
+    struct ast_arg_list *arg = AST_CAST(arg_, struct ast_arg_list);
+    struct ast_push_list *push = AST_CAST(push_, struct ast_push_list);
+    if (!proc_has_var(proc, arg->name) && proc_reads_only(proc, arg->name) &&
+        translate_const_value(push->expr, context, &args[i].value)) {
+      args[i].known = 1;
+      known++;
+    }
+    arg_ = arg->next;
+    push_ = push->next;
+  }
+  return known;
+}
+
+// Whether the call re-enters the procedure being translated: a generic
+// procedure calling itself without constants, or a clone calling itself with
+// the very same constants.
+static int translate_is_self_call(struct ast_proc_call *call,
+                                  struct translate_context *context) {
+  if (strcmp(call->name, context->proc_name) != 0)
+    return 0;
+  int counter;
+  struct ast_procedure *proc =
+      translate_find_proc(context, call->name, &counter);
+  int arg_count = translate_arg_count(
+      AST_CAST(proc->header, struct ast_proc_header)->args);
+  struct translate_const *args =
+      calloc(arg_count + 1, sizeof(struct translate_const));
+  int known = translate_const_args(call, proc, context, args);
+  int self;
+  if (context->proc_clone < 0) {
+    self = !known;
+  } else {
+    self = memcmp(context->clones[context->proc_clone].args, args,
+                  sizeof(struct translate_const) * arg_count) == 0;
+  }
+  free(args);
+  return self;
+}
+
+// Whether a self call that fits into the argument slots of the current
+// procedure is in tail position of the statement.
+static int translate_has_self_tail_call(struct ast *node,
+                                        struct translate_context *context) {
+  if (!node)
+    return 0;
+  if (node->metatable == &ast_metatable_op_list) {
+    struct ast_op_list *list = AST_CAST(node, struct ast_op_list);
+    while (list->next)
+      list = AST_CAST(list->next, struct ast_op_list);
+    return translate_has_self_tail_call(list->op, context);
+  }
+  if (node->metatable == &ast_metatable_if) {
+    struct ast_if *if_ = AST_CAST(node, struct ast_if);
+    int value;
+    if (translate_const_value(if_->cond, context, &value))
+      return translate_has_self_tail_call(
+          value ? if_->if_true : if_->if_false, context);
+    return translate_has_self_tail_call(if_->if_true, context) ||
+           translate_has_self_tail_call(if_->if_false, context);
+  }
+  if (node->metatable == &ast_metatable_proc_call) {
+    struct ast_proc_call *call = AST_CAST(node, struct ast_proc_call);
+    return translate_push_count(call->push_list) <=
+               translate_arg_count(context->proc_args) &&
+           translate_is_self_call(call, context);
+  }
+  return 0;
+}
+
+// Returns the clone of the callee specialized for the constant arguments of
+// the call, or -1 when the call should go to the generic procedure.
+static int translate_specialize(struct ast_proc_call *call,
+                                struct translate_context *context) {
+  if (context->profile && !profile_count(context, context->profile_block))
+    return -1;
+  int counter;
+  struct ast_procedure *proc =
+      translate_find_proc(context, call->name, &counter);
+  if (!proc)
+    return -1;
+  int arg_count = translate_arg_count(
+      AST_CAST(proc->header, struct ast_proc_header)->args);
+  struct translate_const *args =
+      calloc(arg_count + 1, sizeof(struct translate_const));
+  int known = translate_const_args(call, proc, context, args);
+  if (!known) {
+    free(args);
+    return -1;
+  }
+  for (int i = 0; i < context->clone_count; ++i) {
+    struct translate_clone *clone = &context->clones[i];
+    if (clone->proc == proc &&
+        memcmp(clone->args, args, sizeof(struct translate_const) * arg_count) ==
+            0) {
+      free(args);
+      return i;
+    }
+  }
+  // Recursing with different constants, directly or through other
+  // procedures, would only peel one call per clone
+  for (int i = context->proc_clone; i >= 0; i = context->clones[i].parent) {
+    if (context->clones[i].proc == proc) {
+      free(args);
+      return -1;
+    }
+  }
+  int size = ast_size(proc->code);
+  if (size > context->specialize_budget) {
+    free(args);
+    return -1;
+  }
+  context->specialize_budget -= size;
+  if (context->clone_count == context->clone_capacity) {
+    context->clone_capacity =
+        context->clone_capacity ? 2 * context->clone_capacity : 8;
+    context->clones =
+        realloc(context->clones,
+                sizeof(struct translate_clone) * context->clone_capacity);
+  }
+  struct translate_clone *clone = &context->clones[context->clone_count];
+  clone->proc = proc;
+  clone->args = args;
+  clone->arg_count = arg_count;
+  clone->counter = counter;
+  clone->parent = context->proc_clone;
+  return context->clone_count++;
+}
+
 static void ast_traverse_translate_global(struct ast *node,
                                           struct translate_context *context) {
   AST_CAST_SELF(global)
-  ast_traverse_translate(self->item, context);
+  if (self->item->metatable != &ast_metatable_var_list)
+    ast_traverse_translate(self->item, context);
   ast_traverse_translate(self->next, context);
 }
 
+// Stores the initial values of local variables, the slots past a short
+// initializer are zeroed like the ones of globals.
+static void translate_local_init(struct ast *vars) {
+  int shift = 0;
+  for (struct ast *var_ = vars; var_;) {
+    struct ast_var_list *var = AST_CAST(var_, struct ast_var_list);
+    struct ast_decl_var *decl = AST_CAST(var->decl, struct ast_decl_var);
+    shift += decl->size;
+    struct ast *init_ = decl->init;
+    for (int i = 0; decl->init && i < decl->size; ++i) {
+      if (init_) {
+        struct ast_init_list *init = AST_CAST(init_, struct ast_init_list);
+        printf("\tli x3, %d\n", init->value);
+        printf("\tsw x1, %d, x3\n", i - shift);
+        init_ = init->next;
+      } else {
+        printf("\tsw x1, %d, x0\n", i - shift);
+      }
+    }
+    var_ = var->next;
+  }
+}
+
 static void
 ast_traverse_translate_procedure(struct ast *node,
                                  struct translate_context *context) {
@@ -194,7 +786,24 @@ ast_traverse_translate_procedure(struct ast *node,
   if (shift) {
     printf("\taddi x1, x1, %d\n", shift);
   }
-  ast_traverse_translate(self->code, context);
+  context->proc_shift = shift;
+  context->tail = !proc_frame_escapes(self);
+  if (context->tail && translate_has_self_tail_call(self->code, context)) {
+    if (context->proc_clone >= 0) {
+      printf("t_%d_%s:\n", context->proc_clone, context->proc_name);
+    } else {
+      printf("t_%s:\n", context->proc_name);
+    }
+  }
+  translate_local_init(self->vars);
+  int counter = context->profile_counter++;
+  context->tail_jumped = 0;
+  translate_profile_block(self->code, counter, context->profile_counter,
+                          context);
+  context->tail = 0;
+  if (context->tail_jumped) {
+    return;
+  }
   if (shift) {
     printf("\taddi x1, x1, %d\n", -shift);
   }
@@ -205,7 +814,12 @@ static void
 ast_traverse_translate_proc_header(struct ast *node,
                                    struct translate_context *context) {
   AST_CAST_SELF(proc_header)
-  printf("p_%s:\n", self->name);
+  if (context->proc_clone >= 0) {
+    printf("s_%d_%s:\n", context->proc_clone, self->name);
+  } else {
+    printf("p_%s:\n", self->name);
+  }
+  context->proc_name = self->name;
   context->proc_args = self->args;
 }
 
@@ -225,13 +839,35 @@ static void ast_traverse_translate_decl_var(struct ast *node,
                                             struct translate_context *context) {
   AST_CAST_SELF(decl_var)
   printf("g_%s:\n", self->name);
-  printf("\tdata 0 * %d\n", self->size);
+  int size = 0;
+  for (struct ast *init_ = self->init; init_ && size < self->size;) {
+    struct ast_init_list *init = AST_CAST(init_, struct ast_init_list);
+    int run = 0;
+    while (init_ && size + run < self->size &&
+           AST_CAST(init_, struct ast_init_list)->value == init->value) {
+      run++;
+      init_ = AST_CAST(init_, struct ast_init_list)->next;
+    }
+    printf("\tdata %d * %d\n", init->value, run);
+    size += run;
+  }
+  if (size < self->size) {
+    printf("\tdata 0 * %d\n", self->size - size);
+  }
 }
 
+static void
+ast_traverse_translate_init_list(struct ast *node,
+                                 struct translate_context *context) {}
+
 static void ast_traverse_translate_op_list(struct ast *node,
                                            struct translate_context *context) {
   AST_CAST_SELF(op_list)
+  int tail = context->tail;
+  context->tail = tail && !self->next;
+  context->tail_jumped = 0;
   ast_traverse_translate(self->op, context);
+  context->tail = tail;
   ast_traverse_translate(self->next, context);
 }
 
@@ -245,6 +881,46 @@ static void translate_pop(int reg) {
   printf("\tlw x%d, x1, 0\n", reg);
 }
 
+// Replaces the current frame with the callee's one: the evaluated arguments
+// are moved over the arguments of the current procedure and the callee
+// returns straight to our caller. This only works when the callee takes no
+// more arguments than the current procedure, because the caller releases
+// exactly that many slots after the return.
+static void translate_tail_call(struct ast_proc_call *call, int clone,
+                                struct translate_context *context) {
+  int arg_count = translate_push_count(call->push_list);
+  int distance = context->proc_shift + arg_count;
+  context->stack_depth = 0;
+  ast_traverse_translate(call->push_list, context);
+  for (int i = 1; i <= arg_count; ++i) {
+    printf("\tlw x3, x1, %d\n", -i);
+    printf("\tsw x1, %d, x3\n", -i - distance);
+  }
+  context->stack_depth = 0;
+  context->tail_jumped = 1;
+  if (translate_is_self_call(call, context)) {
+    // Self recursion keeps the frame allocated and skips the prologue
+    if (arg_count) {
+      printf("\taddi x1, x1, %d\n", -arg_count);
+    }
+    if (clone >= 0) {
+      printf("\tjal x0, t_%d_%s\n", clone, call->name);
+    } else {
+      printf("\tjal x0, t_%s\n", call->name);
+    }
+    return;
+  }
+  if (distance) {
+    printf("\taddi x1, x1, %d\n", -distance);
+  }
+  if (clone >= 0) {
+    printf("\tjal x0, s_%d_%s\n", clone, call->name);
+  } else {
+    translate_need_proc(context, call->name);
+    printf("\tjal x0, p_%s\n", call->name);
+  }
+}
+
 static void
 ast_traverse_translate_proc_call(struct ast *node,
                                  struct translate_context *context) {
@@ -264,14 +940,26 @@ ast_traverse_translate_proc_call(struct ast *node,
     printf("\tewrite x3\n");
   } else {
     ' ';
+    int clone = translate_specialize(self, context);
+    if (context->tail && translate_push_count(self->push_list) <=
+                             translate_arg_count(context->proc_args)) {
+      translate_tail_call(self, clone, context);
+      return;
+    }
     translate_push(2);
-    context->stack_depth = 0;
+    context->stack_depth = 1;
     ast_traverse_translate(self->push_list, context);
-    printf("\tjal x2, p_%s\n", self->name);
-    if (context->stack_depth) {
-      printf("\taddi x1, x1, %d\n", -context->stack_depth);
+    if (clone >= 0) {
+      printf("\tjal x2, s_%d_%s\n", clone, self->name);
+    } else {
+      translate_need_proc(context, self->name);
+      printf("\tjal x2, p_%s\n", self->name);
+    }
+    if (context->stack_depth > 1) {
+      printf("\taddi x1, x1, %d\n", 1 - context->stack_depth);
     }
     translate_pop(2);
+    context->stack_depth = 0;
   }
 }
 
@@ -299,35 +987,85 @@ static void ast_traverse_translate_assign(struct ast *node,
 static void ast_traverse_translate_if(struct ast *node,
                                       struct translate_context *context) {
   AST_CAST_SELF(if)
+  int counter = context->profile_counter;
+  int true_first = counter + 2;
+  int false_first = true_first + profile_counters(self->if_true);
+  int end = false_first + profile_counters(self->if_false);
+  int value;
+  if (translate_const_value(self->cond, context, &value)) {
+    if (value) {
+      translate_profile_block(self->if_true, counter, true_first, context);
+    } else {
+      translate_profile_block(self->if_false, counter + 1, false_first,
+                              context);
+    }
+    context->profile_counter = end;
+    return;
+  }
   context->register_counter = 3;
   ast_traverse_translate(self->cond, context);
   int label = context->label_counter++;
-  printf("\tbeq x0, x3, if_%d_false\n", label);
-  ast_traverse_translate(self->if_true, context);
-  if (self->if_false) {
-    printf("\tjal x0, if_%d_end\n", label);
+  int jumped;
+  // A hotter else branch becomes the fall-through path. Without an else the
+  // skip is already a single taken branch.
+  if (self->if_false &&
+      profile_count(context, counter + 1) > profile_count(context, counter)) {
+    printf("\tbne x0, x3, if_%d_true\n", label);
+    translate_profile_block(self->if_false, counter + 1, false_first, context);
+    jumped = context->tail_jumped;
+    if (!jumped) {
+      printf("\tjal x0, if_%d_end\n", label);
+    }
+    printf("if_%d_true:\n", label);
+    translate_profile_block(self->if_true, counter, true_first, context);
+  } else {
+    printf("\tbeq x0, x3, if_%d_false\n", label);
+    translate_profile_block(self->if_true, counter, true_first, context);
+    jumped = context->tail_jumped;
+    if ((self->if_false || context->instrument) && !jumped) {
+      printf("\tjal x0, if_%d_end\n", label);
+    }
+    printf("if_%d_false:\n", label);
+    translate_profile_block(self->if_false, counter + 1, false_first, context);
   }
-  printf("if_%d_false:\n", label);
-  ast_traverse_translate(self->if_false, context);
   printf("if_%d_end:\n", label);
+  // The end is unreachable when both branches leave through a tail call
+  context->tail_jumped = self->if_false && jumped && context->tail_jumped;
+  context->profile_counter = end;
 }
 
 static void ast_traverse_translate_while(struct ast *node,
                                          struct translate_context *context) {
   AST_CAST_SELF(while)
+  int value;
+  if (translate_const_value(self->cond, context, &value) && !value) {
+    context->profile_counter += profile_counters(node);
+    return;
+  }
   int label = context->label_counter++;
   printf("\tjal x0, while_%d_cond\n", label);
   printf("while_%d_body:\n", label);
-  ast_traverse_translate(self->body, context);
+  int counter = context->profile_counter++;
+  int tail = context->tail;
+  context->tail = 0;
+  translate_profile_block(self->body, counter, context->profile_counter,
+                          context);
+  context->tail = tail;
   printf("while_%d_cond:\n", label);
   context->register_counter = 3;
   ast_traverse_translate(self->cond, context);
   printf("\tbne x0, x3, while_%d_body\n", label);
+  context->tail_jumped = 0;
 }
 
 static void ast_traverse_translate_binop(struct ast *node,
                                          struct translate_context *context) {
   AST_CAST_SELF(binop)
+  int value;
+  if (translate_const_value(node, context, &value)) {
+    printf("\tli x%d, %d\n", context->register_counter, value);
+    return;
+  }
   ast_traverse_translate(self->left, context);
   context->register_counter++;
   ast_traverse_translate(self->right, context);
@@ -387,6 +1125,11 @@ static void ast_traverse_translate_binop(struct ast *node,
 static void ast_traverse_translate_unop(struct ast *node,
                                         struct translate_context *context) {
   AST_CAST_SELF(unop)
+  int value;
+  if (translate_const_value(node, context, &value)) {
+    printf("\tli x%d, %d\n", context->register_counter, value);
+    return;
+  }
   ast_traverse_translate(self->arg, context);
   switch (self->code) {
   case '-':
@@ -414,9 +1157,6 @@ static void ast_traverse_translate_constant(struct ast *node,
   printf("\tli x%d, %d\n", context->register_counter, self->value);
 }
 
-static struct ast_metatable ast_metatable_var_list;
-static struct ast_metatable ast_metatable_decl_var;
-
 static void ast_traverse_translate_refname(struct ast *node,
                                            struct translate_context *context) {
   AST_CAST_SELF(refname)
@@ -426,7 +1166,8 @@ static void ast_traverse_translate_refname(struct ast *node,
     struct ast_decl_var *decl = AST_CAST(var->decl, struct ast_decl_var);
     shift += decl->size;
     if (strcmp(decl->name, self->name) == 0) {
-      printf("\taddi x%d, x1, %d\n", context->register_counter, -shift);
+      printf("\taddi x%d, x1, %d\n", context->register_counter,
+             -shift - context->stack_depth);
       return;
     }
     var_ = var->next;
@@ -435,14 +1176,187 @@ static void ast_traverse_translate_refname(struct ast *node,
     struct ast_arg_list *arg = AST_CAST(arg_, struct ast_arg_list);
     shift += 1;
     if (strcmp(arg->name, self->name) == 0) {
-      printf("\taddi x%d, x1, %d\n", context->register_counter, -shift);
+      printf("\taddi x%d, x1, %d\n", context->register_counter,
+             -shift - context->stack_depth);
       return;
     }
     arg_ = arg->next;
   }
+  for (int i = 0; i < context->global_count; ++i) {
+    if (strcmp(context->globals[i].decl->name, self->name) == 0)
+      context->globals[i].heat +=
+          profile_count(context, context->profile_block);
+  }
   printf("\tli x%d, g_%s\n", context->register_counter, self->name);
 }
 
+static int translate_proc_compare(void const *a_, void const *b_) {
+  struct translate_proc const *a = a_;
+  struct translate_proc const *b = b_;
+  if (a->count != b->count)
+    return a->count < b->count ? 1 : -1;
+  return a->counter - b->counter;
+}
+
+// Emits the procedures reachable from main hottest first, together with the
+// clones they request. Counters keep their source order numbering so that
+// the profile collected from an instrumented build still applies.
+static void translate_program(struct translate_context *context) {
+  int n = 0;
+  for (struct ast *global_ = context->program; global_;) {
+    n++;
+    global_ = AST_CAST(global_, struct ast_global)->next;
+  }
+  context->procs = malloc(sizeof(struct translate_proc) * n);
+  context->proc_count = 0;
+  int counter = 0;
+  for (struct ast *global_ = context->program; global_;) {
+    struct ast_global *global = AST_CAST(global_, struct ast_global);
+    if (global->item->metatable == &ast_metatable_procedure) {
+      struct translate_proc *entry = &context->procs[context->proc_count++];
+      entry->proc = AST_CAST(global->item, struct ast_procedure);
+      entry->counter = counter;
+      entry->count = profile_count(context, counter);
+      entry->needed = 0;
+      entry->emitted = 0;
+      counter += profile_counters(global->item);
+    }
+    global_ = global->next;
+  }
+  qsort(context->procs, context->proc_count, sizeof(struct translate_proc),
+        &translate_proc_compare);
+  if (!translate_need_proc(context, "main")) {
+    for (int i = 0; i < context->proc_count; ++i)
+      context->procs[i].needed = 1;
+  }
+  // Every emitted procedure may need new ones, so the scan restarts from the
+  // hottest procedure each time; clones follow once no procedure is pending.
+  int clone = 0;
+  for (int changed = 1; changed;) {
+    changed = 0;
+    for (int i = 0; i < context->proc_count && !changed; ++i) {
+      struct translate_proc *entry = &context->procs[i];
+      if (entry->needed && !entry->emitted) {
+        entry->emitted = 1;
+        changed = 1;
+        context->profile_counter = entry->counter;
+        ast_traverse_translate(&entry->proc->base, context);
+      }
+    }
+    if (changed)
+      continue;
+    for (; clone < context->clone_count; ++clone) {
+      changed = 1;
+      context->proc_clone = clone;
+      context->proc_consts = context->clones[clone].args;
+      context->profile_counter = context->clones[clone].counter;
+      ast_traverse_translate(&context->clones[clone].proc->base, context);
+      context->proc_clone = -1;
+      context->proc_consts = NULL;
+    }
+  }
+  context->profile_counter = counter;
+}
+
+static int translate_global_compare(void const *a_, void const *b_) {
+  struct translate_global const *a = *(struct translate_global *const *)a_;
+  struct translate_global const *b = *(struct translate_global *const *)b_;
+  if (a->heat != b->heat)
+    return a->heat < b->heat ? 1 : -1;
+  if (a->decl->size != b->decl->size)
+    return a->decl->size < b->decl->size ? -1 : 1;
+  return a < b ? -1 : a > b;
+}
+
+// Emits all global variables after the code: profiled hot globals first,
+// then scalars packed together, then arrays from the smallest to the largest.
+// Every datum is a single word, so no padding is needed to align it.
+static void translate_data(struct translate_context *context) {
+  struct translate_global **order =
+      malloc(sizeof(struct translate_global *) * (context->global_count + 1));
+  for (int i = 0; i < context->global_count; ++i)
+    order[i] = &context->globals[i];
+  qsort(order, context->global_count, sizeof(struct translate_global *),
+        &translate_global_compare);
+  for (int i = 0; i < context->global_count; ++i)
+    ast_traverse_translate(&order[i]->decl->base, context);
+  free(order);
+}
+
+// Prints "\n#prof\n" followed by every counter in decimal, one per line. The
+// counters themselves are placed next to l_stack_begin by main.
+static void translate_profile_dump(int counters) {
+  static char const header[] = "\n#prof\n";
+  printf("l_prof_dump:\n");
+  for (int i = 0; header[i]; ++i) {
+    printf("\tli x3, %d\n", header[i]);
+    printf("\tewrite x3\n");
+  }
+  printf("\tli x5, l_prof_counters\n");
+  printf("\taddi x6, x5, %d\n", counters);
+  printf("\tli x10, 10\n");
+  printf("\tjal x0, l_prof_dump_cond\n");
+  printf("l_prof_dump_counter:\n");
+  printf("\tlw x7, x5, 0\n");
+  printf("\tli x8, 0\n");
+  printf("l_prof_dump_digit:\n");
+  printf("\trem x9, x7, x10\n");
+  printf("\taddi x9, x9, 48\n");
+  translate_push(9);
+  printf("\taddi x8, x8, 1\n");
+  printf("\tdiv x7, x7, x10\n");
+  printf("\tbne x0, x7, l_prof_dump_digit\n");
+  printf("l_prof_dump_write:\n");
+  translate_pop(9);
+  printf("\tewrite x9\n");
+  printf("\taddi x8, x8, -1\n");
+  printf("\tbne x0, x8, l_prof_dump_write\n");
+  printf("\tewrite x10\n");
+  printf("\taddi x5, x5, 1\n");
+  printf("l_prof_dump_cond:\n");
+  printf("\tslt x9, x5, x6\n");
+  printf("\tbne x0, x9, l_prof_dump_counter\n");
+  printf("\tjalr x0, x2, 0\n");
+}
+
+// Reads the counters that follow the last "\n#prof\n" marker in the output
+// of an instrumented program, returns NULL when there is no such marker.
+static int *profile_load(char const *path, int *size) {
+  static char const marker[] = "\n#prof\n";
+  FILE *file = fopen(path, "r");
+  if (!file)
+    return NULL;
+  int matched = 0;
+  long start = -1;
+  for (int c; (c = fgetc(file)) != EOF;) {
+    if (c == marker[matched]) {
+      matched++;
+    } else {
+      matched = c == '\n';
+    }
+    if (!marker[matched]) {
+      start = ftell(file);
+      matched = 1;
+    }
+  }
+  if (start < 0 || fseek(file, start, SEEK_SET) != 0) {
+    fclose(file);
+    return NULL;
+  }
+  int *profile = malloc(sizeof(int));
+  int capacity = 1;
+  *size = 0;
+  for (int value; fscanf(file, "%d", &value) == 1;) {
+    if (*size == capacity) {
+      capacity *= 2;
+      profile = realloc(profile, sizeof(int) * capacity);
+    }
+    profile[(*size)++] = value;
+  }
+  fclose(file);
+  return profile;
+}
+
 static void ast_free_global(struct ast *node) {
   AST_CAST_SELF(global);
   ast_free(self->item);
@@ -482,6 +1396,13 @@ static void ast_free_var_list(struct ast *node) {
 static void ast_free_decl_var(struct ast *node) {
   AST_CAST_SELF(decl_var);
   free(self->name);
+  ast_free(self->init);
+  free(self);
+}
+
+static void ast_free_init_list(struct ast *node) {
+  AST_CAST_SELF(init_list);
+  ast_free(self->next);
   free(self);
 }
 
@@ -606,7 +1527,8 @@ AST_DEFINE_TYPE_3(procedure, struct ast *, header, struct ast *, vars,
 AST_DEFINE_TYPE_2(proc_header, char *, name, struct ast *, args);
 AST_DEFINE_TYPE_2(arg_list, char *, name, struct ast *, next);
 AST_DEFINE_TYPE_2(var_list, struct ast *, decl, struct ast *, next);
-AST_DEFINE_TYPE_2(decl_var, char *, name, int, size);
+AST_DEFINE_TYPE_3(decl_var, char *, name, int, size, struct ast *, init);
+AST_DEFINE_TYPE_2(init_list, int, value, struct ast *, next);
 AST_DEFINE_TYPE_2(op_list, struct ast *, op, struct ast *, next);
 AST_DEFINE_TYPE_2(proc_call, char *, name, struct ast *, push_list);
 AST_DEFINE_TYPE_2(push_list, struct ast *, expr, struct ast *, next);
@@ -628,24 +1550,82 @@ char *copy_str(char const *s) {
   return result;
 }
 
+int ast_init_list_length(struct ast *list) {
+  int length = 0;
+  for (; list; length++)
+    list = AST_CAST(list, struct ast_init_list)->next;
+  return length;
+}
+
 struct ast *result;
 
 int main(int argc, char **argv) {
+  struct translate_context context;
+  context.register_counter = 0;
+  context.label_counter = 0;
+  context.stack_depth = 0;
+  context.tail = 0;
+  context.tail_jumped = 0;
+  context.instrument = argc > 1 && argv[1][0] == 'i';
+  context.profile_counter = 0;
+  context.profile_block = 0;
+  context.profile = NULL;
+  context.profile_size = 0;
+  if (argc > 1 && argv[1][0] == 'p') {
+    if (argc < 3) {
+      fprintf(stderr, "missing profile file\n");
+      return 1;
+    }
+    context.profile = profile_load(argv[2], &context.profile_size);
+    if (!context.profile) {
+      fprintf(stderr, "cannot read profile %s\n", argv[2]);
+      return 1;
+    }
+  }
+  context.globals = NULL;
+  context.global_count = 0;
+  context.procs = NULL;
+  context.proc_count = 0;
+  context.proc_consts = NULL;
+  context.proc_clone = -1;
+  context.clones = NULL;
+  context.clone_count = 0;
+  context.clone_capacity = 0;
+  context.specialize_budget = SPECIALIZE_BUDGET;
   int retcode = yyparse();
   if (retcode)
     return retcode;
-  if (argc > 1 && argv[1][0] == 't') {
+  context.program = result;
+  translate_collect_globals(&context);
+  if (context.profile && context.profile_size != profile_counters(result)) {
+    fprintf(stderr, "profile %s does not match the program\n", argv[2]);
+    retcode = 1;
+  } else if (argc > 1 && argv[1][0] == 't') {
     ast_traverse_print(result, 0);
   } else {
-    struct translate_context context;
-    context.register_counter = 0;
-    context.label_counter = 0;
     printf("\tli x1, l_stack_begin\n");
     printf("\tjal x2, p_main\n");
+    if (context.instrument) {
+      printf("\tjal x2, l_prof_dump\n");
+    }
     printf("\tebreak\n");
-    ast_traverse_translate(result, &context);
+    translate_program(&context);
+    if (context.instrument) {
+      translate_profile_dump(context.profile_counter);
+    }
+    translate_data(&context);
+    if (context.instrument) {
+      printf("l_prof_counters:\n");
+      printf("\tdata 0 * %d\n", context.profile_counter);
+    }
     printf("l_stack_begin:\n");
   }
+  for (int i = 0; i < context.clone_count; ++i)
+    free(context.clones[i].args);
+  free(context.clones);
+  free(context.globals);
+  free(context.procs);
+  free(context.profile);
   ast_free(result);
-  return 0;
+  return retcode;
 }
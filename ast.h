@@ -9,13 +9,61 @@ char *copy_str(char const *s);
 
 struct ast;
 extern struct ast *result;
+int ast_init_list_length(struct ast *list);
+
+struct translate_const {
+  int known;
+  int value;
+};
+
+struct translate_global {
+  struct ast_decl_var *decl;
+  int constant;
+  int heat;
+};
+
+struct translate_clone {
+  struct ast_procedure *proc;
+  struct translate_const *args;
+  int arg_count;
+  int counter;
+  int parent;
+};
+
+struct translate_proc {
+  struct ast_procedure *proc;
+  int counter;
+  int count;
+  int needed;
+  int emitted;
+};
 
 struct translate_context {
+  struct ast *program;
   struct ast *proc_args;
   struct ast *proc_vars;
+  char const *proc_name;
+  int proc_shift;
+  int tail;
+  int tail_jumped;
   int register_counter;
   int label_counter;
   int stack_depth;
+  int instrument;
+  int profile_counter;
+  int profile_block;
+  int *profile;
+  int profile_size;
+  struct translate_global *globals;
+  int global_count;
+  struct translate_proc *procs;
+  int proc_count;
+  struct translate_const *proc_consts;
+  int proc_clone;
+  struct translate_clone *clones;
+  int clone_count;
+  int clone_capacity;
+  int specialize_budget;
 };
 
 struct ast_metatable {
@@ -75,7 +123,8 @@ AST_DECLARE_TYPE_3(procedure, struct ast *header, struct ast *vars, struct ast *
 AST_DECLARE_TYPE_2(proc_header, char *name, struct ast *args)
 AST_DECLARE_TYPE_2(arg_list, char *name, struct ast *next)
 AST_DECLARE_TYPE_2(var_list, struct ast *decl, struct ast *next)
-AST_DECLARE_TYPE_2(decl_var, char *name, int size)
+AST_DECLARE_TYPE_3(decl_var, char *name, int size, struct ast *init)
+AST_DECLARE_TYPE_2(init_list, int value, struct ast *next)
 AST_DECLARE_TYPE_2(op_list, struct ast *op, struct ast *next)
 AST_DECLARE_TYPE_2(proc_call, char *name, struct ast *push_list)
 AST_DECLARE_TYPE_2(push_list, struct ast *expr, struct ast *next)
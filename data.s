@@ -0,0 +1,178 @@
+	li x1, l_stack_begin
+	jal x2, p_main
+	ebreak
+p_main:
+	sw x1, 0, x2
+	addi x1, x1, 1
+	li x3, 0
+	sw x1, 0, x3
+	addi x1, x1, 1
+	jal x2, s_0_show
+	addi x1, x1, -1
+	addi x1, x1, -1
+	lw x2, x1, 0
+	sw x1, 0, x2
+	addi x1, x1, 1
+	li x3, 4
+	sw x1, 0, x3
+	addi x1, x1, 1
+	jal x2, s_1_show
+	addi x1, x1, -1
+	addi x1, x1, -1
+	lw x2, x1, 0
+	li x3, 48
+	li x4, g_seen
+	lw x4, x4, 0
+	add x3, x3, x4
+	ewrite x3
+	li x3, 10
+	ewrite x3
+	jalr x0, x2, 0
+s_0_show:
+	addi x1, x1, 5
+	li x3, 0
+	sw x1, -1, x3
+	li x3, 35
+	sw x1, -5, x3
+	li x3, 35
+	sw x1, -4, x3
+	sw x1, -3, x0
+	sw x1, -2, x0
+	addi x3, x1, -1
+	li x4, 0
+	sw x3, 0, x4
+	jal x0, while_0_cond
+while_0_body:
+	li x3, g_msg
+	addi x4, x1, -1
+	lw x4, x4, 0
+	add x3, x3, x4
+	lw x3, x3, 0
+	ewrite x3
+	addi x3, x1, -1
+	addi x4, x1, -1
+	lw x4, x4, 0
+	li x5, 1
+	add x4, x4, x5
+	sw x3, 0, x4
+while_0_cond:
+	addi x3, x1, -1
+	lw x3, x3, 0
+	li x4, 6
+	slt x3, x3, x4
+	bne x0, x3, while_0_body
+	li x3, g_pad
+	lw x3, x3, 0
+	ewrite x3
+	addi x3, x1, -5
+	lw x3, x3, 0
+	addi x4, x1, -5
+	li x5, 1
+	add x4, x4, x5
+	lw x4, x4, 0
+	add x3, x3, x4
+	addi x4, x1, -5
+	li x5, 3
+	add x4, x4, x5
+	lw x4, x4, 0
+	add x3, x3, x4
+	ewrite x3
+	li x3, g_msg
+	li x4, 1
+	add x3, x3, x4
+	lw x3, x3, 0
+	li x4, -32
+	add x3, x3, x4
+	ewrite x3
+	li x3, 10
+	ewrite x3
+	li x3, g_seen
+	li x4, g_seen
+	lw x4, x4, 0
+	li x5, 1
+	add x4, x4, x5
+	sw x3, 0, x4
+	addi x1, x1, -5
+	jalr x0, x2, 0
+s_1_show:
+	addi x1, x1, 5
+	li x3, 0
+	sw x1, -1, x3
+	li x3, 35
+	sw x1, -5, x3
+	li x3, 35
+	sw x1, -4, x3
+	sw x1, -3, x0
+	sw x1, -2, x0
+	addi x3, x1, -1
+	li x4, 4
+	sw x3, 0, x4
+	jal x0, while_1_cond
+while_1_body:
+	li x3, g_msg
+	addi x4, x1, -1
+	lw x4, x4, 0
+	add x3, x3, x4
+	lw x3, x3, 0
+	ewrite x3
+	addi x3, x1, -1
+	addi x4, x1, -1
+	lw x4, x4, 0
+	li x5, 1
+	add x4, x4, x5
+	sw x3, 0, x4
+while_1_cond:
+	addi x3, x1, -1
+	lw x3, x3, 0
+	li x4, 6
+	slt x3, x3, x4
+	bne x0, x3, while_1_body
+	li x3, g_pad
+	lw x3, x3, 0
+	ewrite x3
+	addi x3, x1, -5
+	lw x3, x3, 0
+	addi x4, x1, -5
+	li x5, 1
+	add x4, x4, x5
+	lw x4, x4, 0
+	add x3, x3, x4
+	addi x4, x1, -5
+	li x5, 3
+	add x4, x4, x5
+	lw x4, x4, 0
+	add x3, x3, x4
+	ewrite x3
+	li x3, g_msg
+	li x4, 1
+	add x3, x3, x4
+	lw x3, x3, 0
+	li x4, -32
+	add x3, x3, x4
+	ewrite x3
+	li x3, 10
+	ewrite x3
+	li x3, g_seen
+	li x4, g_seen
+	lw x4, x4, 0
+	li x5, 1
+	add x4, x4, x5
+	sw x3, 0, x4
+	addi x1, x1, -5
+	jalr x0, x2, 0
+g_len:
+	data 6 * 1
+g_shift:
+	data -32 * 1
+g_seen:
+	data 0 * 1
+g_msg:
+	data 72 * 1
+	data 101 * 1
+	data 108 * 2
+	data 111 * 1
+	data 10 * 1
+g_pad:
+	data 32 * 3
+	data 0 * 5
+l_stack_begin:
@@ -1,6 +1,41 @@
 	li x1, l_stack_begin
 	jal x2, p_main
 	ebreak
+p_main:
+	sw x1, 0, x2
+	addi x1, x1, 1
+	li x3, g_a
+	sw x1, 0, x3
+	addi x1, x1, 1
+	jal x2, p_scan
+	addi x1, x1, -1
+	addi x1, x1, -1
+	lw x2, x1, 0
+	sw x1, 0, x2
+	addi x1, x1, 1
+	li x3, g_b
+	sw x1, 0, x3
+	addi x1, x1, 1
+	jal x2, p_scan
+	addi x1, x1, -1
+	addi x1, x1, -1
+	lw x2, x1, 0
+	sw x1, 0, x2
+	addi x1, x1, 1
+	li x3, g_a
+	lw x3, x3, 0
+	li x4, g_b
+	lw x4, x4, 0
+	add x3, x3, x4
+	sw x1, 0, x3
+	addi x1, x1, 1
+	jal x2, p_print
+	addi x1, x1, -1
+	addi x1, x1, -1
+	lw x2, x1, 0
+	li x3, 32
+	ewrite x3
+	jalr x0, x2, 0
 p_print:
 	addi x1, x1, 12
 	addi x3, x1, -11
@@ -204,39 +239,4 @@ g_a:
 	data 0 * 1
 g_b:
 	data 0 * 1
-p_main:
-	sw x1, 0, x2
-	addi x1, x1, 1
-	li x3, g_a
-	sw x1, 0, x3
-	addi x1, x1, 1
-	jal x2, p_scan
-	addi x1, x1, -1
-	addi x1, x1, -1
-	lw x2, x1, 0
-	sw x1, 0, x2
-	addi x1, x1, 1
-	li x3, g_b
-	sw x1, 0, x3
-	addi x1, x1, 1
-	jal x2, p_scan
-	addi x1, x1, -1
-	addi x1, x1, -1
-	lw x2, x1, 0
-	sw x1, 0, x2
-	addi x1, x1, 1
-	li x3, g_a
-	lw x3, x3, 0
-	li x4, g_b
-	lw x4, x4, 0
-	add x3, x3, x4
-	sw x1, 0, x3
-	addi x1, x1, 1
-	jal x2, p_print
-	addi x1, x1, -1
-	addi x1, x1, -1
-	lw x2, x1, 0
-	li x3, 32
-	ewrite x3
-	jalr x0, x2, 0
 l_stack_begin:
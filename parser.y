@@ -29,6 +29,8 @@
 %type <ast> declare_vars
 %type <ast> vars
 %type <ast> decl_var
+%type <ast> init_list
+%type <number> init_value
 %type <ast> expr
 %type <ast> code_block
 %type <ast> operator_list
@@ -68,8 +70,25 @@ vars:
   | decl_var          { $$ = ast_new_var_list($1, NULL ); }
   ;
 decl_var:
-    T_IDENTIFIER '[' T_NUMBER ']' { $$ = ast_new_decl_var(copy_str($1), $3 ); }
-  | T_IDENTIFIER                  { $$ = ast_new_decl_var(copy_str($1),  1 ); }
+    T_IDENTIFIER '[' T_NUMBER ']'                            { $$ = ast_new_decl_var(copy_str($1), $3, NULL ); }
+  | T_IDENTIFIER '[' T_NUMBER ']' T_ASSIGN '{' init_list '}' {
+      if (ast_init_list_length($7) > $3) {
+        yyerror("too many initializers");
+        ast_free($7);
+        YYERROR;
+      }
+      $$ = ast_new_decl_var(copy_str($1), $3, $7);
+    }
+  | T_IDENTIFIER                                             { $$ = ast_new_decl_var(copy_str($1),  1, NULL ); }
+  | T_IDENTIFIER T_ASSIGN init_value                         { $$ = ast_new_decl_var(copy_str($1),  1, ast_new_init_list($3, NULL)); }
+  ;
+init_list:
+    init_value ',' init_list { $$ = ast_new_init_list($1, $3   ); }
+  | init_value               { $$ = ast_new_init_list($1, NULL ); }
+  ;
+init_value:
+        T_NUMBER { $$ =  $1; }
+  | '-' T_NUMBER { $$ = -$2; }
   ;
 
 code_block:
@@ -0,0 +1,68 @@
+	li x1, l_stack_begin
+	jal x2, p_main
+	ebreak
+p_main:
+	addi x1, x1, 1
+	li x3, 0
+	sw x1, -1, x3
+	jal x0, while_0_cond
+while_0_body:
+	sw x1, 0, x2
+	addi x1, x1, 1
+	addi x3, x1, -2
+	lw x3, x3, 0
+	sw x1, 0, x3
+	addi x1, x1, 1
+	jal x2, p_mark
+	addi x1, x1, -1
+	addi x1, x1, -1
+	lw x2, x1, 0
+	addi x3, x1, -1
+	addi x4, x1, -1
+	lw x4, x4, 0
+	li x5, 1
+	add x4, x4, x5
+	sw x3, 0, x4
+while_0_cond:
+	addi x3, x1, -1
+	lw x3, x3, 0
+	li x4, 20
+	slt x3, x3, x4
+	bne x0, x3, while_0_body
+	addi x3, x1, -1
+	lw x3, x3, 0
+	li x4, 100
+	slt x3, x4, x3
+	beq x0, x3, if_1_false
+	sw x1, 0, x2
+	addi x1, x1, 1
+	jal x2, p_rare
+	addi x1, x1, -1
+	lw x2, x1, 0
+if_1_false:
+if_1_end:
+	li x3, 10
+	ewrite x3
+	addi x1, x1, -1
+	jalr x0, x2, 0
+p_mark:
+	addi x3, x1, -1
+	lw x3, x3, 0
+	li x4, 5
+	rem x3, x3, x4
+	li x4, 0
+	seq x3, x3, x4
+	bne x0, x3, if_2_true
+	li x3, 46
+	ewrite x3
+	jal x0, if_2_end
+if_2_true:
+	li x3, 124
+	ewrite x3
+if_2_end:
+	jalr x0, x2, 0
+p_rare:
+	li x3, 33
+	ewrite x3
+	jalr x0, x2, 0
+l_stack_begin:
@@ -0,0 +1,154 @@
+	li x1, l_stack_begin
+	jal x2, p_main
+	jal x2, l_prof_dump
+	ebreak
+p_main:
+	addi x1, x1, 1
+	li x3, 0
+	sw x1, -1, x3
+	li x3, l_prof_counters
+	addi x3, x3, 4
+	lw x4, x3, 0
+	addi x4, x4, 1
+	sw x3, 0, x4
+	jal x0, while_0_cond
+while_0_body:
+	li x3, l_prof_counters
+	addi x3, x3, 5
+	lw x4, x3, 0
+	addi x4, x4, 1
+	sw x3, 0, x4
+	sw x1, 0, x2
+	addi x1, x1, 1
+	addi x3, x1, -2
+	lw x3, x3, 0
+	sw x1, 0, x3
+	addi x1, x1, 1
+	jal x2, p_mark
+	addi x1, x1, -1
+	addi x1, x1, -1
+	lw x2, x1, 0
+	addi x3, x1, -1
+	addi x4, x1, -1
+	lw x4, x4, 0
+	li x5, 1
+	add x4, x4, x5
+	sw x3, 0, x4
+while_0_cond:
+	addi x3, x1, -1
+	lw x3, x3, 0
+	li x4, 20
+	slt x3, x3, x4
+	bne x0, x3, while_0_body
+	addi x3, x1, -1
+	lw x3, x3, 0
+	li x4, 100
+	slt x3, x4, x3
+	beq x0, x3, if_1_false
+	li x3, l_prof_counters
+	addi x3, x3, 6
+	lw x4, x3, 0
+	addi x4, x4, 1
+	sw x3, 0, x4
+	sw x1, 0, x2
+	addi x1, x1, 1
+	jal x2, p_rare
+	addi x1, x1, -1
+	lw x2, x1, 0
+	jal x0, if_1_end
+if_1_false:
+	li x3, l_prof_counters
+	addi x3, x3, 7
+	lw x4, x3, 0
+	addi x4, x4, 1
+	sw x3, 0, x4
+if_1_end:
+	li x3, 10
+	ewrite x3
+	addi x1, x1, -1
+	jalr x0, x2, 0
+p_mark:
+	li x3, l_prof_counters
+	addi x3, x3, 0
+	lw x4, x3, 0
+	addi x4, x4, 1
+	sw x3, 0, x4
+	addi x3, x1, -1
+	lw x3, x3, 0
+	li x4, 5
+	rem x3, x3, x4
+	li x4, 0
+	seq x3, x3, x4
+	beq x0, x3, if_2_false
+	li x3, l_prof_counters
+	addi x3, x3, 1
+	lw x4, x3, 0
+	addi x4, x4, 1
+	sw x3, 0, x4
+	li x3, 124
+	ewrite x3
+	jal x0, if_2_end
+if_2_false:
+	li x3, l_prof_counters
+	addi x3, x3, 2
+	lw x4, x3, 0
+	addi x4, x4, 1
+	sw x3, 0, x4
+	li x3, 46
+	ewrite x3
+if_2_end:
+	jalr x0, x2, 0
+p_rare:
+	li x3, l_prof_counters
+	addi x3, x3, 3
+	lw x4, x3, 0
+	addi x4, x4, 1
+	sw x3, 0, x4
+	li x3, 33
+	ewrite x3
+	jalr x0, x2, 0
+l_prof_dump:
+	li x3, 10
+	ewrite x3
+	li x3, 35
+	ewrite x3
+	li x3, 112
+	ewrite x3
+	li x3, 114
+	ewrite x3
+	li x3, 111
+	ewrite x3
+	li x3, 102
+	ewrite x3
+	li x3, 10
+	ewrite x3
+	li x5, l_prof_counters
+	addi x6, x5, 8
+	li x10, 10
+	jal x0, l_prof_dump_cond
+l_prof_dump_counter:
+	lw x7, x5, 0
+	li x8, 0
+l_prof_dump_digit:
+	rem x9, x7, x10
+	addi x9, x9, 48
+	sw x1, 0, x9
+	addi x1, x1, 1
+	addi x8, x8, 1
+	div x7, x7, x10
+	bne x0, x7, l_prof_dump_digit
+l_prof_dump_write:
+	addi x1, x1, -1
+	lw x9, x1, 0
+	ewrite x9
+	addi x8, x8, -1
+	bne x0, x8, l_prof_dump_write
+	ewrite x10
+	addi x5, x5, 1
+l_prof_dump_cond:
+	slt x9, x5, x6
+	bne x0, x9, l_prof_dump_counter
+	jalr x0, x2, 0
+l_prof_counters:
+	data 0 * 8
+l_stack_begin:
@@ -0,0 +1,214 @@
+	li x1, l_stack_begin
+	jal x2, p_main
+	ebreak
+p_main:
+	li x3, g_x
+	eread x4
+	sw x3, 0, x4
+	sw x1, 0, x2
+	addi x1, x1, 1
+	li x3, 2
+	sw x1, 0, x3
+	addi x1, x1, 1
+	li x3, g_x
+	lw x3, x3, 0
+	li x4, 48
+	sub x3, x3, x4
+	sw x1, 0, x3
+	addi x1, x1, 1
+	jal x2, s_0_putd
+	addi x1, x1, -2
+	addi x1, x1, -1
+	lw x2, x1, 0
+	li x3, 32
+	ewrite x3
+	sw x1, 0, x2
+	addi x1, x1, 1
+	li x3, 10
+	sw x1, 0, x3
+	addi x1, x1, 1
+	li x3, 255
+	sw x1, 0, x3
+	addi x1, x1, 1
+	jal x2, s_1_putd
+	addi x1, x1, -2
+	addi x1, x1, -1
+	lw x2, x1, 0
+	li x3, 10
+	ewrite x3
+	sw x1, 0, x2
+	addi x1, x1, 1
+	li x3, 5
+	sw x1, 0, x3
+	addi x1, x1, 1
+	li x3, 45
+	sw x1, 0, x3
+	addi x1, x1, 1
+	jal x2, s_2_line
+	addi x1, x1, -2
+	addi x1, x1, -1
+	lw x2, x1, 0
+	sw x1, 0, x2
+	addi x1, x1, 1
+	li x3, 5
+	sw x1, 0, x3
+	addi x1, x1, 1
+	li x3, 45
+	sw x1, 0, x3
+	addi x1, x1, 1
+	jal x2, s_2_line
+	addi x1, x1, -2
+	addi x1, x1, -1
+	lw x2, x1, 0
+	sw x1, 0, x2
+	addi x1, x1, 1
+	li x3, g_x
+	lw x3, x3, 0
+	li x4, 48
+	sub x3, x3, x4
+	sw x1, 0, x3
+	addi x1, x1, 1
+	li x3, 61
+	sw x1, 0, x3
+	addi x1, x1, 1
+	jal x2, s_3_line
+	addi x1, x1, -2
+	addi x1, x1, -1
+	lw x2, x1, 0
+	jalr x0, x2, 0
+s_0_putd:
+	addi x3, x1, -1
+	lw x3, x3, 0
+	li x4, 1
+	slt x3, x4, x3
+	beq x0, x3, if_0_false
+	sw x1, 0, x2
+	addi x1, x1, 1
+	li x3, 2
+	sw x1, 0, x3
+	addi x1, x1, 1
+	addi x3, x1, -3
+	lw x3, x3, 0
+	li x4, 2
+	div x3, x3, x4
+	sw x1, 0, x3
+	addi x1, x1, 1
+	jal x2, s_0_putd
+	addi x1, x1, -2
+	addi x1, x1, -1
+	lw x2, x1, 0
+if_0_false:
+if_0_end:
+	li x3, 48
+	addi x4, x1, -1
+	lw x4, x4, 0
+	li x5, 2
+	rem x4, x4, x5
+	add x3, x3, x4
+	ewrite x3
+	jalr x0, x2, 0
+s_1_putd:
+	sw x1, 0, x2
+	addi x1, x1, 1
+	li x3, 10
+	sw x1, 0, x3
+	addi x1, x1, 1
+	li x3, 25
+	sw x1, 0, x3
+	addi x1, x1, 1
+	jal x2, p_putd
+	addi x1, x1, -2
+	addi x1, x1, -1
+	lw x2, x1, 0
+	li x3, 53
+	ewrite x3
+	jalr x0, x2, 0
+s_2_line:
+	addi x1, x1, 1
+	li x3, 0
+	sw x1, -1, x3
+	jal x0, while_1_cond
+while_1_body:
+	li x3, 45
+	ewrite x3
+	addi x3, x1, -1
+	addi x4, x1, -1
+	lw x4, x4, 0
+	li x5, 1
+	add x4, x4, x5
+	sw x3, 0, x4
+while_1_cond:
+	addi x3, x1, -1
+	lw x3, x3, 0
+	li x4, 5
+	slt x3, x3, x4
+	bne x0, x3, while_1_body
+	li x3, 10
+	ewrite x3
+	addi x1, x1, -1
+	jalr x0, x2, 0
+s_3_line:
+	addi x1, x1, 1
+	li x3, 0
+	sw x1, -1, x3
+	jal x0, while_2_cond
+while_2_body:
+	li x3, 61
+	ewrite x3
+	addi x3, x1, -1
+	addi x4, x1, -1
+	lw x4, x4, 0
+	li x5, 1
+	add x4, x4, x5
+	sw x3, 0, x4
+while_2_cond:
+	addi x3, x1, -1
+	lw x3, x3, 0
+	addi x4, x1, -3
+	lw x4, x4, 0
+	slt x3, x3, x4
+	bne x0, x3, while_2_body
+	li x3, 10
+	ewrite x3
+	addi x1, x1, -1
+	jalr x0, x2, 0
+p_putd:
+	addi x3, x1, -1
+	lw x3, x3, 0
+	addi x4, x1, -2
+	lw x4, x4, 0
+	li x5, 1
+	sub x4, x4, x5
+	slt x3, x4, x3
+	beq x0, x3, if_3_false
+	sw x1, 0, x2
+	addi x1, x1, 1
+	addi x3, x1, -3
+	lw x3, x3, 0
+	sw x1, 0, x3
+	addi x1, x1, 1
+	addi x3, x1, -3
+	lw x3, x3, 0
+	addi x4, x1, -4
+	lw x4, x4, 0
+	div x3, x3, x4
+	sw x1, 0, x3
+	addi x1, x1, 1
+	jal x2, p_putd
+	addi x1, x1, -2
+	addi x1, x1, -1
+	lw x2, x1, 0
+if_3_false:
+if_3_end:
+	li x3, 48
+	addi x4, x1, -1
+	lw x4, x4, 0
+	addi x5, x1, -2
+	lw x5, x5, 0
+	rem x4, x4, x5
+	add x3, x3, x4
+	ewrite x3
+	jalr x0, x2, 0
+g_x:
+	data 0 * 1
+l_stack_begin:
@@ -0,0 +1,212 @@
+	li x1, l_stack_begin
+	jal x2, p_main
+	ebreak
+p_main:
+	li x3, g_count
+	li x4, 7
+	sw x3, 0, x4
+	sw x1, 0, x2
+	addi x1, x1, 1
+	li x3, g_count
+	lw x3, x3, 0
+	sw x1, 0, x3
+	addi x1, x1, 1
+	jal x2, p_stars
+	addi x1, x1, -1
+	addi x1, x1, -1
+	lw x2, x1, 0
+	sw x1, 0, x2
+	addi x1, x1, 1
+	li x3, g_res
+	sw x1, 0, x3
+	addi x1, x1, 1
+	li x3, g_count
+	lw x3, x3, 0
+	sw x1, 0, x3
+	addi x1, x1, 1
+	jal x2, p_ping
+	addi x1, x1, -2
+	addi x1, x1, -1
+	lw x2, x1, 0
+	li x3, g_res
+	lw x3, x3, 0
+	ewrite x3
+	sw x1, 0, x2
+	addi x1, x1, 1
+	li x3, 3
+	sw x1, 0, x3
+	addi x1, x1, 1
+	jal x2, s_0_keep
+	addi x1, x1, -1
+	addi x1, x1, -1
+	lw x2, x1, 0
+	li x3, 10
+	ewrite x3
+	jalr x0, x2, 0
+p_stars:
+	addi x1, x1, 1
+t_stars:
+	li x3, 42
+	sw x1, -1, x3
+	addi x3, x1, -2
+	lw x3, x3, 0
+	li x4, 0
+	slt x3, x4, x3
+	beq x0, x3, if_0_false
+	addi x3, x1, -1
+	lw x3, x3, 0
+	ewrite x3
+	addi x3, x1, -2
+	lw x3, x3, 0
+	li x4, 1
+	sub x3, x3, x4
+	sw x1, 0, x3
+	addi x1, x1, 1
+	lw x3, x1, -1
+	sw x1, -3, x3
+	addi x1, x1, -1
+	jal x0, t_stars
+if_0_false:
+	li x3, 10
+	sw x1, 0, x3
+	addi x1, x1, 1
+	lw x3, x1, -1
+	sw x1, -3, x3
+	addi x1, x1, -2
+	jal x0, s_1_putc
+if_0_end:
+p_ping:
+	addi x3, x1, -1
+	lw x3, x3, 0
+	li x4, 0
+	seq x3, x3, x4
+	beq x0, x3, if_1_false
+	addi x3, x1, -2
+	lw x3, x3, 0
+	li x4, 80
+	sw x3, 0, x4
+	jal x0, if_1_end
+if_1_false:
+	addi x3, x1, -2
+	lw x3, x3, 0
+	sw x1, 0, x3
+	addi x1, x1, 1
+	addi x3, x1, -2
+	lw x3, x3, 0
+	li x4, 1
+	sub x3, x3, x4
+	sw x1, 0, x3
+	addi x1, x1, 1
+	lw x3, x1, -1
+	sw x1, -3, x3
+	lw x3, x1, -2
+	sw x1, -4, x3
+	addi x1, x1, -2
+	jal x0, p_pong
+if_1_end:
+	jalr x0, x2, 0
+p_pong:
+	addi x3, x1, -1
+	lw x3, x3, 0
+	li x4, 0
+	seq x3, x3, x4
+	beq x0, x3, if_2_false
+	addi x3, x1, -2
+	lw x3, x3, 0
+	li x4, 81
+	sw x3, 0, x4
+	jal x0, if_2_end
+if_2_false:
+	addi x3, x1, -2
+	lw x3, x3, 0
+	sw x1, 0, x3
+	addi x1, x1, 1
+	addi x3, x1, -2
+	lw x3, x3, 0
+	li x4, 1
+	sub x3, x3, x4
+	sw x1, 0, x3
+	addi x1, x1, 1
+	lw x3, x1, -1
+	sw x1, -3, x3
+	lw x3, x1, -2
+	sw x1, -4, x3
+	addi x1, x1, -2
+	jal x0, p_ping
+if_2_end:
+	jalr x0, x2, 0
+s_0_keep:
+	addi x1, x1, 1
+	sw x1, 0, x2
+	addi x1, x1, 1
+	addi x3, x1, -2
+	sw x1, 0, x3
+	addi x1, x1, 1
+	jal x2, p_store
+	addi x1, x1, -1
+	addi x1, x1, -1
+	lw x2, x1, 0
+	addi x3, x1, -1
+	lw x3, x3, 0
+	ewrite x3
+	sw x1, 0, x2
+	addi x1, x1, 1
+	li x3, 2
+	sw x1, 0, x3
+	addi x1, x1, 1
+	jal x2, p_keep
+	addi x1, x1, -1
+	addi x1, x1, -1
+	lw x2, x1, 0
+	addi x1, x1, -1
+	jalr x0, x2, 0
+s_1_putc:
+	li x3, 10
+	ewrite x3
+	jalr x0, x2, 0
+p_store:
+	addi x3, x1, -1
+	lw x3, x3, 0
+	li x4, 33
+	sw x3, 0, x4
+	jalr x0, x2, 0
+p_keep:
+	addi x1, x1, 1
+	addi x3, x1, -2
+	lw x3, x3, 0
+	li x4, 0
+	slt x3, x4, x3
+	beq x0, x3, if_3_false
+	sw x1, 0, x2
+	addi x1, x1, 1
+	addi x3, x1, -2
+	sw x1, 0, x3
+	addi x1, x1, 1
+	jal x2, p_store
+	addi x1, x1, -1
+	addi x1, x1, -1
+	lw x2, x1, 0
+	addi x3, x1, -1
+	lw x3, x3, 0
+	ewrite x3
+	sw x1, 0, x2
+	addi x1, x1, 1
+	addi x3, x1, -3
+	lw x3, x3, 0
+	li x4, 1
+	sub x3, x3, x4
+	sw x1, 0, x3
+	addi x1, x1, 1
+	jal x2, p_keep
+	addi x1, x1, -1
+	addi x1, x1, -1
+	lw x2, x1, 0
+if_3_false:
+if_3_end:
+	addi x1, x1, -1
+	jalr x0, x2, 0
+g_res:
+	data 0 * 1
+g_count:
+	data 0 * 1
+l_stack_begin: